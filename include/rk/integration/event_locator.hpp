@@ -0,0 +1,149 @@
+#pragma once
+
+#include "rk/integration/integrator.hpp"
+
+#include "kit/debug/log.hpp"
+#include "kit/utility/type_constraints.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace rk
+{
+// Detects zero crossings of user registered event functions g(t, y) after every accepted embedded step. Each event
+// function is vectorized: every component of its output is an independent event. When a sign change is found, the
+// earliest crossing is located with the Illinois method on a continuous extension of the step: the tableau weights
+// become polynomials in the fraction of the step that satisfy the order conditions up to order five (or the highest
+// the tableau allows), applied to the stored k-vectors plus the derivative at the end of the step. That root is then
+// refined with a single Newton correction from a sub-step of the integrator's own tableau, and a second sub-step takes
+// the integrator to the event, so that both keep the order of the method at the cost of two sub-steps per crossing.
+// The user may stop there, or modify the state and keep integrating without triggering the same event again. Only the
+// step endpoints are checked, so ts.max must remain below the shortest time between two crossings of the same event
+template <std::floating_point Float> class event_locator final
+{
+  public:
+    using event_fn = std::function<std::vector<Float>(Float, const std::vector<Float> &)>;
+
+    struct event
+    {
+        std::size_t function;
+        std::size_t index;
+        Float time;
+    };
+
+    event_locator(Float tolerance = 1e-8f, std::uint32_t max_iterations = 64);
+
+    Float tolerance;
+    std::uint32_t max_iterations;
+
+    void add(const event_fn &fn);
+    void clear();
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    bool embedded_forward(integrator<Float> &integ, ODE &&ode)
+    {
+        m_triggered = false;
+        if (m_events.empty())
+            return integ.embedded_forward(std::forward<ODE>(ode));
+
+        if (m_stale || m_time != integ.elapsed)
+        {
+            evaluate(integ.elapsed, integ.state.vars(), m_previous);
+            settle();
+        }
+
+        m_start = integ.state.vars();
+        m_time = integ.elapsed;
+        bool valid = integ.embedded_forward(std::forward<ODE>(ode));
+        m_step = integ.elapsed - m_time;
+
+        evaluate(integ.elapsed, integ.state.vars(), m_current);
+        if (!crossed())
+        {
+            std::swap(m_previous, m_current);
+            m_time = integ.elapsed;
+            return valid;
+        }
+
+        const std::vector<Float> derivative = ode(integ.elapsed, m_step, integ.state.vars());
+        KIT_ASSERT_ERROR(derivative.size() == m_start.size(),
+                         "ODE function must return a vector of the same size as the state vector")
+        interpolant(integ, derivative);
+
+        // The extension is only accurate to its own order, so the root is corrected once with the event function
+        // evaluated on a sub-step of the tableau, which has the order of the method
+        Float lerp = locate();
+        if (lerp < 1.f)
+        {
+            valid &= substep(integ, ode, lerp);
+            const Float value = m_events[m_event.function](m_time + lerp * m_step, m_interpolated)[m_event.index];
+            if (m_slope != 0.f)
+                lerp = std::clamp(lerp - value / m_slope, static_cast<Float>(0.f), static_cast<Float>(1.f));
+        }
+        if (lerp < 1.f)
+        {
+            valid &= substep(integ, ode, lerp);
+            integ.state.vars(m_interpolated);
+            integ.elapsed = m_time + lerp * m_step;
+        }
+        m_event.time = integ.elapsed;
+
+        m_triggered = true;
+        m_stale = true;
+        m_settle = true;
+        return valid;
+    }
+
+    // Must be called if the state or time of the integrator are modified outside of an event
+    void reset();
+
+    bool triggered() const;
+    const event &last_event() const;
+
+  private:
+    std::vector<event_fn> m_events;
+    std::vector<std::vector<Float>> m_previous;
+    std::vector<std::vector<Float>> m_current;
+
+    std::vector<Float> m_start;
+    std::vector<Float> m_interpolated;
+    Float m_time = 0.f;
+    Float m_step = 0.f;
+    Float m_slope = 0.f;
+
+    std::vector<Float> m_signature;
+    std::vector<std::vector<Float>> m_weights;
+    std::vector<std::vector<Float>> m_coefficients;
+
+    event m_event{};
+    Float m_before = 0.f;
+    bool m_triggered = false;
+    bool m_stale = true;
+    bool m_settle = false;
+
+    // Takes a single step of the integrator tableau from the start of the last step into m_interpolated
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    bool substep(const integrator<Float> &integ, ODE &ode, const Float lerp)
+    {
+        integrator<Float> sub = integ;
+        sub.state.vars(m_start);
+        sub.elapsed = m_time;
+        sub.ts = {lerp * m_step};
+        const bool valid = sub.raw_forward(ode);
+        m_interpolated = sub.state.vars();
+        return valid;
+    }
+
+    void evaluate(Float time, const std::vector<Float> &vars, std::vector<std::vector<Float>> &values) const;
+    bool crossed() const;
+    void settle();
+
+    Float locate();
+    Float illinois(std::size_t function, std::size_t index);
+
+    void extension(const butcher_tableau<Float> &tableau);
+    void interpolant(const integrator<Float> &integ, const std::vector<Float> &derivative);
+    void interpolate(Float lerp, std::vector<Float> &vars) const;
+};
+} // namespace rk
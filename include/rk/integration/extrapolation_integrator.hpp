@@ -0,0 +1,179 @@
+#pragma once
+
+#include "rk/integration/state.hpp"
+#include "rk/numerical/timestep.hpp"
+#include "rk/multithreading/task_pool.hpp"
+
+#include "kit/debug/log.hpp"
+#include "kit/utility/type_constraints.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace rk
+{
+// Gragg-Bulirsch-Stoer integrator. Each step runs the modified midpoint rule with an increasing number of substeps
+// (2, 4, 6...) and extrapolates the results to a zero substep with the Aitken-Neville scheme. Both the step size and
+// the amount of columns (and thus the order) adapt to the tolerance, which makes it very efficient for smooth
+// problems at tight tolerances. The state holds a single k-vector: the derivative at the beginning of the step
+template <std::floating_point Float> class extrapolation_integrator final
+{
+  public:
+    static inline constexpr Float TOL_PART = 256.f;
+
+    extrapolation_integrator(const timestep<Float> &ts = {1.e-3f}, const std::vector<Float> &vars = {},
+                             Float tolerance = 1e-4f, std::uint32_t columns = 8);
+
+    rk::state<Float> state;
+    timestep<Float> ts;
+
+    Float tolerance;
+    Float elapsed = 0.f;
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    bool forward(ODE &&ode)
+    {
+        return advance(ode, [this, &ode](const std::uint32_t column, std::uint32_t, const Float step) {
+            midpoint(ode, column, step);
+        });
+    }
+
+    // Same as forward, but computes the independent midpoint sequences of a step concurrently. The ODE must be safe
+    // to call from several threads at once
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE, TaskPool Pool>
+    bool forward(ODE &&ode, Pool &pool)
+    {
+        return advance(ode, [this, &ode, &pool](const std::uint32_t column, const std::uint32_t last,
+                                                const Float step) {
+            if (column != 0)
+                return;
+            std::vector<decltype(pool.submit([] {}))> tasks;
+            tasks.reserve(last);
+            for (std::uint32_t i = last; i > 0; i--)
+                tasks.push_back(pool.submit([this, &ode, i, step] { midpoint(ode, i, step); }));
+            midpoint(ode, 0, step);
+            for (auto &task : tasks)
+                task.wait();
+        });
+    }
+
+    std::uint32_t columns() const;
+    std::uint32_t order() const;
+
+    Float error() const;
+    bool valid() const;
+
+  private:
+    struct sequence
+    {
+        std::vector<Float> result;
+        std::vector<Float> previous;
+        std::vector<Float> current;
+    };
+
+    std::uint32_t m_columns;
+    std::uint32_t m_target;
+
+    std::vector<sequence> m_sequences;
+    std::vector<std::vector<Float>> m_table;
+    std::vector<std::uint32_t> m_cost;
+    std::vector<Float> m_steps;
+    std::vector<Float> m_work;
+
+    Float m_error = 0.f;
+    bool m_valid = true;
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE, typename Compute>
+    bool advance(ODE &ode, Compute &&compute)
+    {
+        m_valid = true;
+
+        if (ts.limited)
+            ts.clamp();
+
+        std::vector<Float> &vars = state.m_vars;
+        resize_buffers();
+
+        const std::vector<Float> derivative = ode(elapsed, ts.value, vars);
+        KIT_ASSERT_ERROR(derivative.size() == vars.size(),
+                         "ODE function must return a vector of the same size as the state vector")
+        for (std::size_t i = 0; i < vars.size(); i++)
+            state(0, i) = derivative[i];
+
+        for (;;)
+        {
+            const Float step = ts.value;
+            const std::uint32_t last = m_target + 1;
+            // The step has already been clamped, so being at the minimum means it cannot shrink any further
+            const bool too_small = ts.limited && ts.value <= ts.min;
+
+            std::uint32_t accepted = 0;
+            for (std::uint32_t column = 0; column <= last; column++)
+            {
+                compute(column, last, step);
+                extrapolate(column, step);
+                if (column + 1 >= m_target && (m_error <= tolerance || (too_small && column == last)))
+                {
+                    accepted = column;
+                    break;
+                }
+            }
+
+            if (accepted != 0)
+            {
+                vars = m_table[0];
+                if (too_small)
+                    ts.value = ts.min;
+                elapsed += ts.value;
+                select_order(accepted);
+                break;
+            }
+            ts.value = m_steps[m_target];
+            if (ts.limited)
+                ts.clamp();
+        }
+        for (const Float val : vars)
+            m_valid &= !std::isnan(val);
+
+        KIT_ASSERT_WARN(m_valid, "NaN encountered when computing extrapolation solution.")
+        return m_valid;
+    }
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    void midpoint(ODE &ode, const std::uint32_t column, const Float step)
+    {
+        const std::vector<Float> &vars = state.m_vars;
+        sequence &seq = m_sequences[column];
+
+        const std::uint32_t substeps = 2 * (column + 1);
+        const Float h = step / static_cast<Float>(substeps);
+
+        seq.previous = vars;
+        for (std::size_t i = 0; i < vars.size(); i++)
+            seq.current[i] = vars[i] + h * state(0, i);
+
+        for (std::uint32_t m = 1; m < substeps; m++)
+        {
+            const std::vector<Float> derivative = ode(elapsed + static_cast<Float>(m) * h, h, seq.current);
+            KIT_ASSERT_ERROR(derivative.size() == vars.size(),
+                             "ODE function must return a vector of the same size as the state vector")
+            for (std::size_t i = 0; i < vars.size(); i++)
+            {
+                const Float next = seq.previous[i] + 2.f * h * derivative[i];
+                seq.previous[i] = seq.current[i];
+                seq.current[i] = next;
+            }
+        }
+
+        const std::vector<Float> derivative = ode(elapsed + step, h, seq.current);
+        KIT_ASSERT_ERROR(derivative.size() == vars.size(),
+                         "ODE function must return a vector of the same size as the state vector")
+        for (std::size_t i = 0; i < vars.size(); i++)
+            seq.result[i] = 0.5f * (seq.current[i] + seq.previous[i] + h * derivative[i]);
+    }
+
+    void resize_buffers();
+    void extrapolate(std::uint32_t column, Float step);
+    void select_order(std::uint32_t column);
+};
+} // namespace rk
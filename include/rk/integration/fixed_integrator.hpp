@@ -0,0 +1,219 @@
+#pragma once
+
+#include "rk/numerical/fixed_butcher_tableau.hpp"
+#include "rk/numerical/timestep.hpp"
+
+#include "kit/debug/log.hpp"
+#include "kit/utility/type_constraints.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace rk
+{
+// Stack-allocated counterpart of integrator for small systems whose size is known at compile time. The tableau is
+// passed by reference (see fixed_butcher_tableau.hpp), so its coefficients are constant expressions and nothing is
+// ever allocated. The timestep bounds are checked in place rather than through the out of line timestep methods, so
+// that a whole step can be inlined. Results are identical to those of integrator with the equivalent butcher_tableau
+template <std::floating_point Float, std::size_t N, const auto &Tableau> class fixed_integrator final
+{
+  public:
+    using array = std::array<Float, N>;
+
+    static inline constexpr std::uint32_t stages = std::remove_cvref_t<decltype(Tableau)>::stages;
+    static inline constexpr Float TOL_PART = 256.f;
+
+    static_assert(std::is_same_v<typename decltype(Tableau.coefs1)::value_type, Float>,
+                  "The tableau floating point type must match the integrator's");
+
+    fixed_integrator(const timestep<Float> &ts = {1.e-3f}, const array &vars = {}, Float tolerance = 1e-4f)
+        : state(vars), ts(ts), tolerance(tolerance)
+    {
+    }
+
+    array state;
+    timestep<Float> ts;
+
+    Float tolerance;
+    Float elapsed = 0.f;
+
+    template <kit::RetCallable<array, Float, Float, const array &> ODE> bool raw_forward(ODE &&ode)
+    {
+        m_valid = true;
+
+        if (ts.limited)
+            ts.value = std::clamp(ts.value, ts.min, ts.max);
+
+        update_kvec(elapsed, ts.value, state, std::forward<ODE>(ode));
+
+        if constexpr (Tableau.embedded)
+        {
+            const array aux_state = generate_solution(ts.value, state, Tableau.coefs2);
+            state = generate_solution(ts.value, state, Tableau.coefs1);
+            m_error = embedded_error(state, aux_state);
+        }
+        else
+            state = generate_solution(ts.value, state, Tableau.coefs1);
+        elapsed += ts.value;
+        KIT_ASSERT_WARN(m_valid, "NaN encountered when computing runge-kutta solution.")
+        return m_valid;
+    }
+
+    template <kit::RetCallable<array, Float, Float, const array &> ODE>
+    bool reiterative_forward(ODE &&ode, std::uint32_t reiterations = 2)
+    {
+        KIT_ASSERT_CRITICAL(reiterations >= 2,
+                            "The amount of reiterations has to be greater than 1, otherwise the algorithm will break.")
+        KIT_ASSERT_WARN(
+            !Tableau.embedded,
+            "Butcher tableau has an embedded solution. Use an embedded adaptive method for better efficiency.")
+
+        m_valid = true;
+
+        if (m_error > 0.f)
+            ts.value *= timestep_factor();
+        if (ts.limited)
+            ts.value = std::clamp(ts.value, ts.min, ts.max);
+
+        for (;;)
+        {
+            array sol1 = state;
+            update_kvec(elapsed, ts.value, state, std::forward<ODE>(ode));
+
+            const array sol2 = generate_solution(ts.value, state, Tableau.coefs1);
+            for (std::uint32_t i = 0; i < reiterations; i++)
+            {
+                update_kvec(elapsed, ts.value / reiterations, sol1, std::forward<ODE>(ode));
+                sol1 = generate_solution(ts.value / reiterations, sol1, Tableau.coefs1);
+            }
+            m_error = reiterative_error(sol1, sol2);
+
+            const bool too_small = ts.limited && ts.value < ts.min;
+            if (m_error <= tolerance || too_small)
+            {
+                state = sol1;
+                if (too_small)
+                    ts.value = ts.min;
+                break;
+            }
+            ts.value *= timestep_factor();
+        }
+        m_error = std::max(m_error, tolerance / TOL_PART);
+        elapsed += ts.value;
+
+        KIT_ASSERT_WARN(m_valid, "NaN encountered when computing runge-kutta solution.")
+        return m_valid;
+    }
+
+    template <kit::RetCallable<array, Float, Float, const array &> ODE> bool embedded_forward(ODE &&ode)
+    {
+        static_assert(Tableau.embedded, "Cannot perform embedded adaptive stepsize without an embedded solution.");
+        m_valid = true;
+
+        if (m_error > 0.f)
+            ts.value *= timestep_factor();
+        if (ts.limited)
+            ts.value = std::clamp(ts.value, ts.min, ts.max);
+
+        for (;;)
+        {
+            update_kvec(elapsed, ts.value, state, std::forward<ODE>(ode));
+            const array sol2 = generate_solution(ts.value, state, Tableau.coefs2);
+            const array sol1 = generate_solution(ts.value, state, Tableau.coefs1);
+            m_error = embedded_error(sol1, sol2);
+
+            const bool too_small = ts.limited && ts.value < ts.min;
+            if (m_error <= tolerance || too_small)
+            {
+                state = sol1;
+                if (too_small)
+                    ts.value = ts.min;
+                break;
+            }
+            ts.value *= timestep_factor();
+        }
+        m_error = std::max(m_error, tolerance / TOL_PART);
+        elapsed += ts.value;
+
+        KIT_ASSERT_WARN(m_valid, "NaN encountered when computing runge-kutta solution.")
+        return m_valid;
+    }
+
+    Float operator()(const std::uint32_t stage, const std::size_t index) const
+    {
+        KIT_ASSERT_ERROR(stage < stages, "Stage exceeds container size: {0}", stage)
+        KIT_ASSERT_ERROR(index < N, "Index exceeds container size: {0}", index)
+        return m_kvec[stage][index];
+    }
+
+    Float error() const
+    {
+        return m_error;
+    }
+    bool valid() const
+    {
+        return m_valid;
+    }
+
+  private:
+    static inline constexpr Float SAFETY_FACTOR = 0.85f;
+
+    std::array<array, stages> m_kvec{};
+    Float m_error = 0.f;
+    bool m_valid = true;
+
+    template <kit::RetCallable<array, Float, Float, const array &> ODE>
+    void update_kvec(const Float time, const Float timestep, const array &vars, ODE &&ode)
+    {
+        KIT_ASSERT_ERROR(timestep >= 0.f, "Timestep must be non-negative")
+
+        m_kvec[0] = std::forward<ODE>(ode)(time, timestep, vars);
+        for (std::uint32_t i = 1; i < stages; i++)
+        {
+            array aux_vars;
+            for (std::size_t j = 0; j < N; j++)
+            {
+                Float k_sum = 0.f;
+                for (std::uint32_t k = 0; k < i; k++)
+                    k_sum += Tableau.beta[i - 1][k] * m_kvec[k][j];
+                aux_vars[j] = vars[j] + k_sum * timestep;
+            }
+            m_kvec[i] = std::forward<ODE>(ode)(time + Tableau.alpha[i - 1] * timestep, timestep, aux_vars);
+        }
+    }
+
+    array generate_solution(const Float timestep, const array &vars, const std::array<Float, stages> &coefs)
+    {
+        array sol;
+        for (std::size_t j = 0; j < N; j++)
+        {
+            Float sum = 0.0;
+            for (std::uint32_t i = 0; i < stages; i++)
+                sum += coefs[i] * m_kvec[i][j];
+            m_valid &= !std::isnan(sum);
+
+            sol[j] = vars[j] + sum * timestep;
+        }
+        return sol;
+    }
+
+    static Float embedded_error(const array &sol1, const array &sol2)
+    {
+        Float result = 0.0;
+        for (std::size_t i = 0; i < N; i++)
+            result += (sol1[i] - sol2[i]) * (sol1[i] - sol2[i]);
+        return result;
+    }
+    static Float reiterative_error(const array &sol1, const array &sol2)
+    {
+        constexpr std::uint32_t coeff = (1u << Tableau.order) - 1;
+        return embedded_error(sol1, sol2) / coeff;
+    }
+    Float timestep_factor() const
+    {
+        return SAFETY_FACTOR * std::pow(tolerance / m_error, 1.f / Tableau.order);
+    }
+};
+} // namespace rk
@@ -6,7 +6,10 @@
 
 #include "kit/debug/log.hpp"
 #include "kit/utility/type_constraints.hpp"
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 
 namespace rk
 {
@@ -40,7 +43,7 @@ template <std::floating_point Float> class integrator final
 
         if (m_tableau.embedded)
         {
-            static std::vector<Float> aux_state;
+            static thread_local std::vector<Float> aux_state;
             aux_state = generate_solution(ts.value, vars, m_tableau.coefs2);
             vars = generate_solution(ts.value, vars, m_tableau.coefs1);
             m_error = embedded_error(vars, aux_state);
@@ -58,7 +61,7 @@ template <std::floating_point Float> class integrator final
         KIT_ASSERT_CRITICAL(reiterations >= 2,
                             "The amount of reiterations has to be greater than 1, otherwise the algorithm will break.")
         KIT_ASSERT_WARN(
-            !m_tableau.embedded(),
+            !m_tableau.embedded,
             "Butcher tableau has an embedded solution. Use an embedded adaptive method for better efficiency.")
 
         m_valid = true;
@@ -70,8 +73,8 @@ template <std::floating_point Float> class integrator final
 
         for (;;)
         {
-            static std::vector<Float> sol1;
-            static std::vector<Float> sol2;
+            static thread_local std::vector<Float> sol1;
+            static thread_local std::vector<Float> sol2;
 
             std::vector<Float> &vars = state.m_vars;
             sol1 = vars;
@@ -105,7 +108,7 @@ template <std::floating_point Float> class integrator final
     template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
     bool embedded_forward(ODE &&ode)
     {
-        KIT_ASSERT_CRITICAL(m_tableau.embedded(),
+        KIT_ASSERT_CRITICAL(m_tableau.embedded,
                             "Cannot perform embedded adaptive stepsize without an embedded solution.")
         m_valid = true;
 
@@ -116,8 +119,8 @@ template <std::floating_point Float> class integrator final
 
         for (;;)
         {
-            static std::vector<Float> sol1;
-            static std::vector<Float> sol2;
+            static thread_local std::vector<Float> sol1;
+            static thread_local std::vector<Float> sol2;
 
             std::vector<Float> &vars = state.m_vars;
             update_kvec(elapsed, ts.value, vars, std::forward<ODE>(ode));
@@ -142,6 +145,52 @@ template <std::floating_point Float> class integrator final
         return m_valid;
     }
 
+    // Takes as many embedded steps as needed to reach until, shortening the last ones so that elapsed lands on it. If
+    // the last step had to be cut short, the timestep and error are restored to what they were before it, so that the
+    // next call proposes the same step it would have taken without the cut
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    bool embedded_forward(ODE &&ode, const Float until)
+    {
+        KIT_ASSERT_ERROR(until >= elapsed, "Cannot integrate backwards in time")
+        const timestep<Float> bounds = ts;
+        const Float threshold =
+            4.f * std::numeric_limits<Float>::epsilon() * std::max(std::abs(until), static_cast<Float>(1.f));
+
+        bool valid = true;
+        bool cut = false;
+        Float step = ts.value;
+        Float error = m_error;
+        while (until - elapsed > threshold)
+        {
+            const Float remaining = until - elapsed;
+            Float proposal = m_error > 0.f ? ts.value * timestep_factor() : ts.value;
+            if (bounds.limited)
+                proposal = std::min(proposal, bounds.max);
+
+            cut = proposal > remaining;
+            if (cut)
+            {
+                step = ts.value;
+                error = m_error;
+            }
+
+            ts.min = bounds.limited ? std::min(bounds.min, remaining) : 0.f;
+            ts.max = bounds.limited ? std::min(bounds.max, remaining) : remaining;
+            ts.limited = true;
+            valid &= embedded_forward(std::forward<ODE>(ode));
+        }
+        if (cut)
+        {
+            ts.value = step;
+            m_error = error;
+        }
+        ts.min = bounds.min;
+        ts.max = bounds.max;
+        ts.limited = bounds.limited;
+        elapsed = until;
+        return valid;
+    }
+
     const butcher_tableau<Float> &tableau() const;
     void tableau(const butcher_tableau<Float> &tableau);
 
@@ -161,7 +210,7 @@ template <std::floating_point Float> class integrator final
                          "State and k-vectors size mismatch! - vars size: {0}, k-vectors size: {1}", vars.size(),
                          state.m_kvec.size() / m_tableau.stages)
 
-        static std::vector<Float> aux_vars;
+        static thread_local std::vector<Float> aux_vars;
         aux_vars.resize(vars.size());
 
         auto state_derivative = std::forward<ODE>(ode)(time, timestep, vars);
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "rk/integration/integrator.hpp"
+
+#include "kit/debug/log.hpp"
+#include "kit/utility/type_constraints.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace rk
+{
+// Integrates a system whose variables are partitioned into rate groups, ordered from slowest to fastest. Each group
+// owns an integrator with its own timestep and tolerance. The slowest group takes an adaptive macro step and every
+// faster group then sub-cycles up to the end of it. While a group is integrated, the already advanced (slower) groups
+// are interpolated with a quadratic through both ends of the macro step and the start of the previous one, and the
+// faster ones are extrapolated with a quadratic through the starts of the current and two previous macro steps (lower
+// degrees are used until there is enough history). The error made by that extrapolation is estimated at the end of
+// the macro step from two extra evaluations of each non-fastest group and checked against that group's tolerance. If
+// too large, the whole macro step is repeated with a smaller size. The ODE is called with the index of the group being
+// integrated and must only return the derivatives of that group's variables, in partition order. It may take the whole
+// state either as a vector, rebuilt on every call, or as a coupling view, which only evaluates the entries it reads
+template <std::floating_point Float> class multirate_integrator final
+{
+  public:
+    using partition = std::vector<std::vector<std::size_t>>;
+
+    class coupling
+    {
+      public:
+        Float operator[](const std::size_t index) const
+        {
+            return m_integrator.coupled(index, m_group, m_span, m_vars);
+        }
+        std::size_t size() const
+        {
+            return m_integrator.m_vars.size();
+        }
+
+      private:
+        coupling(const multirate_integrator &integ, const std::size_t group, const Float time,
+                 const std::vector<Float> &vars)
+            : m_integrator(integ), m_vars(vars), m_group(group), m_span(time - integ.elapsed)
+        {
+        }
+
+        const multirate_integrator &m_integrator;
+        const std::vector<Float> &m_vars;
+        std::size_t m_group;
+        Float m_span;
+
+        friend class multirate_integrator;
+    };
+
+    static inline constexpr Float TOL_PART = 256.f;
+
+    multirate_integrator(const butcher_tableau<Float> &bt, const partition &groups,
+                         const timestep<Float> &ts = {1.e-3f}, const std::vector<Float> &vars = {},
+                         Float tolerance = 1e-4f);
+
+    Float elapsed = 0.f;
+
+    template <typename ODE>
+        requires kit::RetCallable<ODE, std::vector<Float>, std::size_t, Float, Float, const std::vector<Float> &> ||
+                 kit::RetCallable<ODE, std::vector<Float>, std::size_t, Float, Float, const coupling &>
+    bool forward(ODE &&ode)
+    {
+        KIT_ASSERT_CRITICAL(m_groups[0].tableau().embedded,
+                            "Cannot perform multirate integration without an embedded solution.")
+        m_start = m_vars;
+        m_snapshot = m_groups;
+        compute_derivatives();
+
+        for (;;)
+        {
+            const bool valid = macro_forward(ode);
+            if (m_groups.size() == 1)
+            {
+                elapsed += m_macro_step;
+                return valid;
+            }
+
+            Float ratio = 0.f;
+            const Float end = elapsed + m_macro_step;
+            for (std::size_t g = 0; g + 1 < m_groups.size(); g++)
+            {
+                std::vector<Float> guess;
+                std::vector<Float> actual;
+                if constexpr (lazy<ODE>)
+                {
+                    // The slower groups are interpolated at the end of the macro step, where they match m_vars
+                    guess = ode(g, end, m_macro_step, coupling(*this, g, end, m_groups[g].state.vars()));
+                    actual = ode(g, end, m_macro_step,
+                                 coupling(*this, m_groups.size() - 1, end, m_groups.back().state.vars()));
+                }
+                else
+                {
+                    m_coupled = m_vars;
+                    extrapolate(g, end);
+                    guess = ode(g, end, m_macro_step, m_coupled);
+                    actual = ode(g, end, m_macro_step, m_vars);
+                }
+                ratio = std::max(ratio, coupling_error(guess, actual) / m_groups[g].tolerance);
+            }
+
+            const bool too_small = m_groups[0].ts.limited && m_macro_step <= m_groups[0].ts.min;
+            m_coupling_step = m_macro_step * coupling_factor(ratio);
+            if (ratio <= 1.f || too_small)
+            {
+                m_history[1] = m_history[0];
+                m_history[0] = m_start;
+                m_history_steps[1] = m_history_steps[0];
+                m_history_steps[0] = m_macro_step;
+                elapsed += m_macro_step;
+                return valid;
+            }
+            m_groups = m_snapshot;
+            m_vars = m_start;
+        }
+    }
+
+    const std::vector<Float> &vars() const;
+    void vars(const std::vector<Float> &vars);
+
+    Float operator[](std::size_t index) const;
+
+    std::size_t groups() const;
+    const integrator<Float> &group(std::size_t index) const;
+    integrator<Float> &group(std::size_t index);
+
+    const partition &indices() const;
+    Float macro_step() const;
+
+  private:
+    partition m_partition;
+    std::vector<std::size_t> m_owners;
+    std::vector<std::size_t> m_positions;
+    std::vector<integrator<Float>> m_groups;
+    std::vector<integrator<Float>> m_snapshot;
+
+    std::vector<Float> m_vars;
+    std::vector<Float> m_start;
+    std::vector<Float> m_coupled;
+    std::array<std::vector<Float>, 2> m_history;
+    std::array<Float, 2> m_history_steps{};
+    std::vector<Float> m_slopes;
+    std::vector<Float> m_curvatures;
+    std::vector<Float> m_interpolation_slopes;
+    std::vector<Float> m_interpolation_curvatures;
+    std::uint32_t m_degree = 0;
+
+    Float m_macro_step = 0.f;
+    Float m_coupling_step = 0.f;
+
+    template <typename ODE>
+    static inline constexpr bool lazy =
+        kit::RetCallable<ODE, std::vector<Float>, std::size_t, Float, Float, const coupling &>;
+
+    template <typename ODE> bool macro_forward(ODE &ode)
+    {
+        if constexpr (!lazy<ODE>)
+            m_coupled = m_start;
+
+        bool valid = true;
+        for (std::size_t g = 0; g < m_groups.size(); g++)
+        {
+            const auto group_ode = [this, g, &ode](const Float t, const Float dt,
+                                                   const std::vector<Float> &vars) -> std::vector<Float> {
+                if constexpr (lazy<ODE>)
+                    return ode(g, t, dt, coupling(*this, g, t, vars));
+                else
+                {
+                    couple(g, t);
+                    for (std::size_t i = 0; i < vars.size(); i++)
+                        m_coupled[m_partition[g][i]] = vars[i];
+                    return ode(g, t, dt, m_coupled);
+                }
+            };
+
+            integrator<Float> &integ = m_groups[g];
+            integ.elapsed = elapsed;
+            if (g == 0)
+            {
+                // The slowest group is additionally limited by the step the coupling error allows
+                const timestep<Float> bounds = integ.ts;
+                if (m_coupling_step > 0.f && m_groups.size() > 1)
+                {
+                    integ.ts.min = bounds.limited ? std::min(bounds.min, m_coupling_step) : 0.f;
+                    integ.ts.max = bounds.limited ? std::min(bounds.max, m_coupling_step) : m_coupling_step;
+                    integ.ts.limited = true;
+                }
+                valid &= integ.embedded_forward(group_ode);
+                integ.ts.min = bounds.min;
+                integ.ts.max = bounds.max;
+                integ.ts.limited = bounds.limited;
+                m_macro_step = integ.elapsed - elapsed;
+            }
+            else
+                valid &= integ.embedded_forward(group_ode, elapsed + m_macro_step);
+            scatter(g);
+            interpolation(g);
+        }
+        return valid;
+    }
+
+    Float interpolated(const std::size_t index, const Float span) const
+    {
+        return m_start[index] + span * m_interpolation_slopes[index] +
+               span * (span - m_macro_step) * m_interpolation_curvatures[index];
+    }
+    Float extrapolated(const std::size_t index, const Float span) const
+    {
+        return m_start[index] + span * m_slopes[index] + span * (span + m_history_steps[0]) * m_curvatures[index];
+    }
+    Float coupled(const std::size_t index, const std::size_t group, const Float span,
+                  const std::vector<Float> &vars) const
+    {
+        KIT_ASSERT_ERROR(index < m_owners.size(), "Index exceeds container size: {0}", index)
+        const std::size_t owner = m_owners[index];
+        if (owner == group)
+            return vars[m_positions[index]];
+        return owner < group ? interpolated(index, span) : extrapolated(index, span);
+    }
+
+    void interpolation(std::size_t group);
+    void couple(std::size_t group, Float time);
+    void extrapolate(std::size_t group, Float time);
+    void compute_derivatives();
+    Float coupling_error(const std::vector<Float> &guess, const std::vector<Float> &actual) const;
+    Float coupling_factor(Float ratio) const;
+
+    void gather();
+    void scatter(std::size_t group);
+};
+} // namespace rk
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "rk/integration/integrator.hpp"
+#include "rk/multithreading/task_pool.hpp"
+
+#include "kit/debug/log.hpp"
+#include "kit/utility/type_constraints.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace rk
+{
+// Parallel-in-time driver. The interval is split into slices whose initial values are first predicted serially by a
+// cheap coarse integrator. Each iteration then integrates every unconverged slice with the fine integrator in
+// parallel and propagates the correction G(new) + F(old) - G(old) serially through the slice boundaries, until the
+// largest squared boundary correction falls below the tolerance. Integrators with an embedded tableau are stepped
+// adaptively with embedded_forward, the rest take fixed raw_forward steps of roughly their ts value
+template <std::floating_point Float> class parareal final
+{
+  public:
+    struct report
+    {
+        std::uint32_t iterations = 0;
+        Float correction = 0.f;
+        bool converged = false;
+
+        double wall_time = 0.0;
+
+        // Sum of the last fine timing of every slice. Slices are timed while running concurrently and competing for
+        // cores, so this overestimates a serial fine run and the derived speedup is biased upwards under contention
+        double concurrent_fine_time = 0.0;
+        double estimated_speedup = 0.0;
+
+        // Only measured when time_serial is set, by running the fine integrator serially over the whole interval
+        double serial_fine_time = 0.0;
+        double speedup = 0.0;
+    };
+
+    parareal(const integrator<Float> &coarse, const integrator<Float> &fine, std::uint32_t slices,
+             Float tolerance = 1e-6f, std::uint32_t max_iterations = 0);
+
+    Float tolerance;
+    // Zero, or anything above the amount of slices, iterates until every slice has been corrected
+    std::uint32_t max_iterations;
+    bool time_serial = false;
+
+    // Spreads the slices over at most one thread per core, the calling one included. The ODE must be safe to call from
+    // several threads at once
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    const report &run(ODE &&ode, const std::vector<Float> &vars, const Float begin, const Float end)
+    {
+        return advance(ode, vars, begin, end, [this, &ode](const std::uint32_t first) {
+            const std::uint32_t slices = (std::uint32_t)m_fine.size();
+            const std::uint32_t workers = std::min(slices - first, std::max(std::thread::hardware_concurrency(), 1u));
+            const auto batch = [this, &ode, first, slices, workers](const std::uint32_t worker) {
+                for (std::uint32_t i = first + worker; i < slices; i += workers)
+                    fine(ode, i);
+            };
+
+            std::vector<std::thread> threads;
+            threads.reserve(workers - 1);
+            for (std::uint32_t i = 1; i < workers; i++)
+                threads.emplace_back(batch, i);
+            batch(0);
+            for (std::thread &thread : threads)
+                thread.join();
+        });
+    }
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE, TaskPool Pool>
+    const report &run(ODE &&ode, const std::vector<Float> &vars, const Float begin, const Float end, Pool &pool)
+    {
+        return advance(ode, vars, begin, end, [this, &ode, &pool](const std::uint32_t first) {
+            std::vector<decltype(pool.submit([] {}))> tasks;
+            tasks.reserve(m_fine.size() - first);
+            for (std::uint32_t i = first; i < m_fine.size(); i++)
+                tasks.push_back(pool.submit([this, &ode, i] { fine(ode, i); }));
+            for (auto &task : tasks)
+                task.wait();
+        });
+    }
+
+    const std::vector<Float> &vars() const;
+    const std::vector<std::vector<Float>> &boundaries() const;
+
+    std::uint32_t slices() const;
+    const report &last_report() const;
+    bool valid() const;
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    integrator<Float> m_coarse;
+    integrator<Float> m_coarse_work;
+    integrator<Float> m_fine_template;
+    std::vector<integrator<Float>> m_fine;
+
+    std::vector<Float> m_times;
+    std::vector<std::vector<Float>> m_boundaries;
+    std::vector<std::vector<Float>> m_coarse_solutions;
+    std::vector<std::vector<Float>> m_fine_solutions;
+    std::vector<Float> m_prediction;
+    std::vector<double> m_fine_times;
+    std::vector<char> m_fine_valid;
+
+    report m_report;
+    bool m_valid = true;
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE, typename Dispatch>
+    const report &advance(ODE &ode, const std::vector<Float> &vars, const Float begin, const Float end,
+                          Dispatch &&dispatch)
+    {
+        KIT_ASSERT_ERROR(end > begin, "The integration interval must not be empty")
+        const auto start = clock::now();
+        prepare(vars, begin, end);
+
+        const std::uint32_t slices = (std::uint32_t)m_fine.size();
+        for (std::uint32_t i = 0; i < slices; i++)
+        {
+            coarse(ode, i, m_coarse_solutions[i]);
+            m_boundaries[i + 1] = m_coarse_solutions[i];
+        }
+
+        // After k iterations the first k slices are exact, so the solution matches the serial fine one once every
+        // slice has been corrected and there is nothing left to iterate
+        const std::uint32_t iterations = max_iterations == 0 ? slices : std::min(max_iterations, slices);
+        for (std::uint32_t k = 0; k < iterations; k++)
+        {
+            dispatch(k);
+            for (std::uint32_t i = k; i < slices; i++)
+                m_valid &= m_fine_valid[i] != 0;
+
+            m_report.correction = 0.f;
+            for (std::uint32_t i = k; i < slices; i++)
+            {
+                // The boundary at the start of slice k did not change, so its coarse prediction is already known
+                if (i == k)
+                    m_prediction = m_coarse_solutions[i];
+                else
+                    coarse(ode, i, m_prediction);
+
+                std::vector<Float> &boundary = m_boundaries[i + 1];
+                Float correction = 0.f;
+                for (std::size_t j = 0; j < boundary.size(); j++)
+                {
+                    const Float corrected = m_prediction[j] + m_fine_solutions[i][j] - m_coarse_solutions[i][j];
+                    correction += (corrected - boundary[j]) * (corrected - boundary[j]);
+                    boundary[j] = corrected;
+                }
+                m_coarse_solutions[i] = m_prediction;
+                m_report.correction = std::max(m_report.correction, correction);
+            }
+            m_report.iterations = k + 1;
+            if (m_report.correction <= tolerance || m_report.iterations == slices)
+            {
+                m_report.converged = true;
+                break;
+            }
+        }
+
+        m_report.wall_time = std::chrono::duration<double>(clock::now() - start).count();
+        for (const double time : m_fine_times)
+            m_report.concurrent_fine_time += time;
+        m_report.estimated_speedup = m_report.concurrent_fine_time / m_report.wall_time;
+
+        if (time_serial)
+        {
+            const auto serial_start = clock::now();
+            integrator<Float> serial = m_fine_template;
+            serial.state.vars(vars);
+            serial.elapsed = begin;
+            m_valid &= propagate(serial, ode, end);
+            m_report.serial_fine_time = std::chrono::duration<double>(clock::now() - serial_start).count();
+            m_report.speedup = m_report.serial_fine_time / m_report.wall_time;
+        }
+
+        KIT_ASSERT_WARN(m_valid, "NaN encountered when computing parareal solution.")
+        KIT_ASSERT_WARN(m_report.converged, "Parareal did not converge after {0} iterations. Last correction: {1}",
+                        m_report.iterations, m_report.correction)
+        return m_report;
+    }
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    void coarse(ODE &ode, const std::uint32_t slice, std::vector<Float> &solution)
+    {
+        m_coarse_work = m_coarse;
+        m_coarse_work.state.vars(m_boundaries[slice]);
+        m_coarse_work.elapsed = m_times[slice];
+        m_valid &= propagate(m_coarse_work, ode, m_times[slice + 1]);
+        solution = m_coarse_work.state.vars();
+    }
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    void fine(ODE &ode, const std::uint32_t slice)
+    {
+        const auto start = clock::now();
+        integrator<Float> &integ = m_fine[slice];
+        integ.state.vars(m_boundaries[slice]);
+        integ.elapsed = m_times[slice];
+        m_fine_valid[slice] = propagate(integ, ode, m_times[slice + 1]);
+        m_fine_solutions[slice] = integ.state.vars();
+        m_fine_times[slice] = std::chrono::duration<double>(clock::now() - start).count();
+    }
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    static bool propagate(integrator<Float> &integ, ODE &ode, const Float until)
+    {
+        if (integ.tableau().embedded)
+            return integ.embedded_forward(ode, until);
+
+        const Float span = until - integ.elapsed;
+        const Float step = integ.ts.value;
+        const std::uint32_t steps = std::max(1u, (std::uint32_t)std::ceil(span / step));
+
+        bool valid = true;
+        integ.ts.value = span / static_cast<Float>(steps);
+        for (std::uint32_t i = 0; i < steps; i++)
+            valid &= integ.raw_forward(ode);
+        integ.ts.value = step;
+        integ.elapsed = until;
+        return valid;
+    }
+
+    void prepare(const std::vector<Float> &vars, Float begin, Float end);
+};
+} // namespace rk
@@ -40,5 +40,6 @@ template <std::floating_point Float> class state
     std::uint32_t m_stages;
 
     template <std::floating_point U> friend class integrator;
+    template <std::floating_point U> friend class extrapolation_integrator;
 };
 } // namespace rk
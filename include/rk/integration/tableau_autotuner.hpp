@@ -0,0 +1,118 @@
+#pragma once
+
+#include "rk/integration/integrator.hpp"
+
+#include "kit/debug/log.hpp"
+#include "kit/utility/type_constraints.hpp"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace rk
+{
+// Picks the cheapest tableau for a given problem at runtime. Every candidate is run in turn for a short calibration
+// window of real steps (the integration keeps advancing), timing the RHS and the whole step. The one with the lowest
+// wall time per simulated second is then locked in until the next calibration, which happens every period steps.
+// Tableaus are switched through integrator::tableau(), so the state, elapsed time and timestep carry over
+template <std::floating_point Float> class tableau_autotuner final
+{
+  public:
+    struct candidate
+    {
+        candidate(const butcher_tableau<Float> &tableau, std::uint32_t reiterations = 0);
+
+        butcher_tableau<Float> tableau;
+        // Zero selects embedded_forward, otherwise reiterative_forward with this many reiterations
+        std::uint32_t reiterations;
+
+        double rhs_time = 0.0;
+        double wall_time = 0.0;
+        Float simulated = 0.f;
+        std::uint32_t evaluations = 0;
+        std::uint32_t steps = 0;
+
+        double cost() const;
+        Float mean_step() const;
+        double mean_rhs_time() const;
+        Float rejection_rate() const;
+
+        void reset();
+    };
+
+    tableau_autotuner(std::uint32_t window = 16, std::uint32_t period = 1024);
+    tableau_autotuner(const std::vector<candidate> &candidates, std::uint32_t window = 16,
+                      std::uint32_t period = 1024);
+
+    std::uint32_t window;
+    std::uint32_t period;
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    bool forward(integrator<Float> &integ, ODE &&ode)
+    {
+        if (!m_calibrating && m_since_calibration >= period)
+            recalibrate();
+        if (!m_calibrating)
+        {
+            m_since_calibration++;
+            return step(integ, m_candidates[m_selected], ode);
+        }
+
+        candidate &cand = m_candidates[m_calibrated];
+        if (m_active != m_calibrated)
+            install(integ, m_calibrated);
+
+        // The first step of a window is a warm-up, letting the timestep adapt to the new tableau
+        if (m_window_steps++ == 0)
+            return step(integ, cand, ode);
+
+        const auto timed_ode = [&cand, &ode](const Float t, const Float dt, const std::vector<Float> &vars) {
+            const auto start = clock::now();
+            auto derivative = ode(t, dt, vars);
+            cand.rhs_time += std::chrono::duration<double>(clock::now() - start).count();
+            cand.evaluations++;
+            return derivative;
+        };
+
+        const Float elapsed = integ.elapsed;
+        const auto start = clock::now();
+        const bool valid = step(integ, cand, timed_ode);
+        cand.wall_time += std::chrono::duration<double>(clock::now() - start).count();
+        cand.simulated += integ.elapsed - elapsed;
+        cand.steps++;
+
+        if (m_window_steps > window)
+            next_candidate(integ);
+        return valid;
+    }
+
+    const std::vector<candidate> &candidates() const;
+    const candidate &selected() const;
+    std::size_t selection() const;
+
+    bool calibrating() const;
+    void recalibrate();
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    std::vector<candidate> m_candidates;
+    std::size_t m_selected = 0;
+    std::size_t m_active = SIZE_MAX;
+    std::size_t m_calibrated = 0;
+
+    std::uint32_t m_window_steps = 0;
+    std::uint32_t m_since_calibration = 0;
+    bool m_calibrating = true;
+
+    template <kit::RetCallable<std::vector<Float>, Float, Float, const std::vector<Float> &> ODE>
+    static bool step(integrator<Float> &integ, const candidate &cand, ODE &&ode)
+    {
+        if (cand.reiterations == 0)
+            return integ.embedded_forward(std::forward<ODE>(ode));
+        return integ.reiterative_forward(std::forward<ODE>(ode), cand.reiterations);
+    }
+
+    void install(integrator<Float> &integ, std::size_t index);
+    void next_candidate(integrator<Float> &integ);
+};
+} // namespace rk
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <concepts>
+#include <functional>
+#include <utility>
+
+namespace rk
+{
+// Any thread pool whose submit(task) accepts a capturing callable and returns a waitable handle, such as a
+// std::future<void>
+template <typename Pool>
+concept TaskPool = requires(Pool &pool, std::function<void()> task) { pool.submit(std::move(task)).wait(); };
+} // namespace rk
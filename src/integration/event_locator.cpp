@@ -0,0 +1,330 @@
+#include "rk/internal/pch.hpp"
+#include "rk/integration/event_locator.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+// The built-in tableaus are written with float literals, so their order conditions only hold to float precision
+#define PIVOT_TOLERANCE 4e-6f
+#define CONSISTENCY_TOLERANCE 1e-4f
+
+namespace rk
+{
+template <std::floating_point Float>
+event_locator<Float>::event_locator(const Float tolerance, const std::uint32_t max_iterations)
+    : tolerance(tolerance), max_iterations(max_iterations)
+{
+}
+
+template <std::floating_point Float> void event_locator<Float>::add(const event_fn &fn)
+{
+    m_events.push_back(fn);
+    m_stale = true;
+}
+template <std::floating_point Float> void event_locator<Float>::clear()
+{
+    m_events.clear();
+    m_stale = true;
+}
+
+template <std::floating_point Float>
+void event_locator<Float>::evaluate(const Float time, const std::vector<Float> &vars,
+                                    std::vector<std::vector<Float>> &values) const
+{
+    values.resize(m_events.size());
+    for (std::size_t i = 0; i < m_events.size(); i++)
+        values[i] = m_events[i](time, vars);
+}
+
+template <std::floating_point Float> bool event_locator<Float>::crossed() const
+{
+    for (std::size_t i = 0; i < m_events.size(); i++)
+    {
+        KIT_ASSERT_ERROR(m_previous[i].size() == m_current[i].size(),
+                         "Event functions must always return the same amount of values")
+        for (std::size_t j = 0; j < m_current[i].size(); j++)
+            if (m_previous[i][j] * m_current[i][j] < 0.f || (m_current[i][j] == 0.f && m_previous[i][j] != 0.f))
+                return true;
+    }
+    return false;
+}
+
+// Right after an event the state lies on the crossing up to the integrator error, possibly still on the side it came
+// from. Its sign is not trusted then, so that the same crossing does not fire twice
+template <std::floating_point Float> void event_locator<Float>::settle()
+{
+    if (!m_settle)
+        return;
+    m_settle = false;
+    if (m_event.function >= m_previous.size() || m_event.index >= m_previous[m_event.function].size())
+        return;
+
+    Float &value = m_previous[m_event.function][m_event.index];
+    if ((value > 0.f) == (m_before > 0.f))
+        value = 0.f;
+}
+
+template <std::floating_point Float> Float event_locator<Float>::locate()
+{
+    KIT_PERF_SCOPE("rk::event_locator::locate")
+    Float earliest = 1.f;
+    for (std::size_t i = 0; i < m_events.size(); i++)
+        for (std::size_t j = 0; j < m_current[i].size(); j++)
+        {
+            const Float before = m_previous[i][j];
+            const Float after = m_current[i][j];
+            if (before * after >= 0.f && (after != 0.f || before == 0.f))
+                continue;
+
+            const Float lerp = after == 0.f ? 1.f : illinois(i, j);
+            if (lerp <= earliest)
+            {
+                earliest = lerp;
+                m_before = before;
+                m_event = {i, j, m_time + lerp * m_step};
+            }
+        }
+
+    // The final bracket is too narrow for a meaningful slope, so it is taken from a central difference instead
+    if (earliest < 1.f)
+    {
+        const Float delta = std::cbrt(std::numeric_limits<Float>::epsilon());
+        const event_fn &fn = m_events[m_event.function];
+        interpolate(earliest + delta, m_interpolated);
+        const Float ahead = fn(m_time + (earliest + delta) * m_step, m_interpolated)[m_event.index];
+        interpolate(earliest - delta, m_interpolated);
+        const Float behind = fn(m_time + (earliest - delta) * m_step, m_interpolated)[m_event.index];
+        m_slope = (ahead - behind) / (2.f * delta);
+    }
+    return earliest;
+}
+
+// Returns the root estimate inside the final bracket
+template <std::floating_point Float>
+Float event_locator<Float>::illinois(const std::size_t function, const std::size_t index)
+{
+    Float lo = 0.f;
+    Float hi = 1.f;
+    Float glo = m_previous[function][index];
+    Float ghi = m_current[function][index];
+    int side = 0;
+
+    for (std::uint32_t i = 0; i < max_iterations && (hi - lo) * m_step > tolerance; i++)
+    {
+        const Float lerp = (lo * ghi - hi * glo) / (ghi - glo);
+        interpolate(lerp, m_interpolated);
+        const Float glerp = m_events[function](m_time + lerp * m_step, m_interpolated)[index];
+        if (glerp == 0.f)
+            return lerp;
+
+        if ((glerp > 0.f) == (ghi > 0.f))
+        {
+            hi = lerp;
+            ghi = glerp;
+            if (side == 1)
+                glo *= 0.5f;
+            side = 1;
+        }
+        else
+        {
+            lo = lerp;
+            glo = glerp;
+            if (side == -1)
+                ghi *= 0.5f;
+            side = -1;
+        }
+    }
+    return std::clamp((lo * ghi - hi * glo) / (ghi - glo), lo, hi);
+}
+
+// Finds the weights of a continuous extension, b_i(lerp) = sum_k w_ik lerp^(k + 1), over the tableau stages plus the
+// derivative at the end of the step (a stage with the tableau weights as its row). They must satisfy the order
+// conditions with lerp^order / gamma as right hand side, for every tree up to the highest order (at most five) for
+// which the system has a solution
+template <std::floating_point Float> void event_locator<Float>::extension(const butcher_tableau<Float> &tableau)
+{
+    const std::uint32_t stages = tableau.stages + 1;
+    std::vector<Float> signature(tableau.coefs1.begin(), tableau.coefs1.end());
+    signature.insert(signature.end(), tableau.alpha.begin(), tableau.alpha.end());
+    for (const auto &row : tableau.beta)
+        signature.insert(signature.end(), row.begin(), row.end());
+    if (signature == m_signature && m_weights.size() == stages)
+        return;
+    m_signature = signature;
+
+    std::vector<std::vector<Float>> a(stages, std::vector<Float>(stages, 0.f));
+    std::vector<Float> c(stages, 1.f);
+    c[0] = 0.f;
+    for (std::uint32_t i = 1; i < tableau.stages; i++)
+    {
+        c[i] = tableau.alpha[i - 1];
+        for (std::uint32_t k = 0; k < i; k++)
+            a[i][k] = tableau.beta[i - 1][k];
+    }
+    for (std::uint32_t k = 0; k < tableau.stages; k++)
+        a[stages - 1][k] = tableau.coefs1[k];
+
+    // Elementary weights of every rooted tree up to order five, built from the products with a and c
+    const auto product = [&a, stages](const std::vector<Float> &v) {
+        std::vector<Float> result(stages, 0.f);
+        for (std::uint32_t i = 0; i < stages; i++)
+            for (std::uint32_t k = 0; k < i; k++)
+                result[i] += a[i][k] * v[k];
+        return result;
+    };
+    const auto times = [stages](const std::vector<Float> &u, const std::vector<Float> &v) {
+        std::vector<Float> result(stages);
+        for (std::uint32_t i = 0; i < stages; i++)
+            result[i] = u[i] * v[i];
+        return result;
+    };
+
+    const std::vector<Float> ones(stages, 1.f);
+    const std::vector<Float> c2 = times(c, c);
+    const std::vector<Float> c3 = times(c2, c);
+    const std::vector<Float> ac = product(c);
+    const std::vector<Float> ac2 = product(c2);
+    const std::vector<Float> aac = product(ac);
+    const std::vector<Float> cac = times(c, ac);
+
+    struct condition
+    {
+        std::vector<Float> phi;
+        std::uint32_t order;
+        Float gamma;
+    };
+    const std::array<condition, 17> conditions{{{ones, 1, 1.f},
+                                                {c, 2, 2.f},
+                                                {c2, 3, 3.f},
+                                                {ac, 3, 6.f},
+                                                {c3, 4, 4.f},
+                                                {cac, 4, 8.f},
+                                                {ac2, 4, 12.f},
+                                                {aac, 4, 24.f},
+                                                {times(c3, c), 5, 5.f},
+                                                {times(c2, ac), 5, 10.f},
+                                                {times(c, ac2), 5, 15.f},
+                                                {times(c, aac), 5, 30.f},
+                                                {times(ac, ac), 5, 20.f},
+                                                {product(c3), 5, 20.f},
+                                                {product(cac), 5, 40.f},
+                                                {product(ac2), 5, 60.f},
+                                                {product(aac), 5, 120.f}}};
+
+    for (std::uint32_t order = std::min(tableau.order, 5u); order > 0; order--)
+    {
+        // Gauss-Jordan elimination on the conditions, with one right hand side column per power of lerp
+        std::size_t rows = 0;
+        while (rows < conditions.size() && conditions[rows].order <= order)
+            rows++;
+        const std::size_t columns = stages + order;
+        std::vector<std::vector<Float>> system(rows, std::vector<Float>(columns, 0.f));
+        for (std::size_t r = 0; r < rows; r++)
+        {
+            std::copy(conditions[r].phi.begin(), conditions[r].phi.end(), system[r].begin());
+            system[r][stages + conditions[r].order - 1] = 1.f / conditions[r].gamma;
+        }
+
+        std::vector<std::size_t> pivots;
+        for (std::size_t col = 0; col < stages && pivots.size() < rows; col++)
+        {
+            const std::size_t top = pivots.size();
+            std::size_t best = top;
+            for (std::size_t r = top + 1; r < rows; r++)
+                if (std::abs(system[r][col]) > std::abs(system[best][col]))
+                    best = r;
+            if (std::abs(system[best][col]) <= PIVOT_TOLERANCE)
+                continue;
+
+            std::swap(system[top], system[best]);
+            const Float pivot = system[top][col];
+            for (Float &val : system[top])
+                val /= pivot;
+            for (std::size_t r = 0; r < rows; r++)
+                if (r != top && system[r][col] != 0.f)
+                {
+                    const Float factor = system[r][col];
+                    for (std::size_t k = 0; k < columns; k++)
+                        system[r][k] -= factor * system[top][k];
+                }
+            pivots.push_back(col);
+        }
+
+        bool consistent = true;
+        for (std::size_t r = pivots.size(); r < rows; r++)
+            for (std::size_t k = stages; k < columns; k++)
+                consistent &= std::abs(system[r][k]) <= CONSISTENCY_TOLERANCE;
+        if (!consistent)
+            continue;
+
+        m_weights.assign(stages, std::vector<Float>(order, 0.f));
+        for (std::size_t r = 0; r < pivots.size(); r++)
+            for (std::uint32_t k = 0; k < order; k++)
+                m_weights[pivots[r]][k] = system[r][stages + k];
+        return;
+    }
+}
+
+// Polynomial coefficients of the extension, plus a last term of one degree higher that makes it match the end of the
+// step exactly, as the mismatch is already of that order
+template <std::floating_point Float>
+void event_locator<Float>::interpolant(const integrator<Float> &integ, const std::vector<Float> &derivative)
+{
+    extension(integ.tableau());
+    const std::uint32_t stages = integ.tableau().stages;
+    const std::size_t degree = m_weights.front().size();
+    const std::vector<Float> &end = integ.state.vars();
+
+    m_coefficients.resize(degree + 1);
+    std::vector<Float> &last = m_coefficients.back();
+    last.resize(end.size());
+    for (std::size_t j = 0; j < end.size(); j++)
+        last[j] = end[j] - m_start[j];
+
+    for (std::size_t k = 0; k < degree; k++)
+    {
+        std::vector<Float> &coefs = m_coefficients[k];
+        coefs.assign(end.size(), 0.f);
+        for (std::uint32_t i = 0; i < stages; i++)
+            if (m_weights[i][k] != 0.f)
+                for (std::size_t j = 0; j < end.size(); j++)
+                    coefs[j] += m_weights[i][k] * integ.state(i, j);
+        for (std::size_t j = 0; j < end.size(); j++)
+        {
+            coefs[j] = m_step * (coefs[j] + m_weights[stages][k] * derivative[j]);
+            last[j] -= coefs[j];
+        }
+    }
+}
+
+template <std::floating_point Float>
+void event_locator<Float>::interpolate(const Float lerp, std::vector<Float> &vars) const
+{
+    vars = m_coefficients.back();
+    for (std::size_t k = m_coefficients.size() - 1; k-- > 0;)
+        for (std::size_t j = 0; j < vars.size(); j++)
+            vars[j] = vars[j] * lerp + m_coefficients[k][j];
+    for (std::size_t j = 0; j < vars.size(); j++)
+        vars[j] = vars[j] * lerp + m_start[j];
+}
+
+template <std::floating_point Float> void event_locator<Float>::reset()
+{
+    m_stale = true;
+}
+
+template <std::floating_point Float> bool event_locator<Float>::triggered() const
+{
+    return m_triggered;
+}
+
+template <std::floating_point Float>
+const typename event_locator<Float>::event &event_locator<Float>::last_event() const
+{
+    return m_event;
+}
+
+template class event_locator<float>;
+template class event_locator<double>;
+template class event_locator<long double>;
+} // namespace rk
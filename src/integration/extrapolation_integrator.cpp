@@ -0,0 +1,106 @@
+#include "rk/internal/pch.hpp"
+#include "rk/integration/extrapolation_integrator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#define SAFETY_FACTOR 0.85f
+#define MIN_FACTOR 0.02f
+#define MAX_FACTOR 4.f
+
+namespace rk
+{
+template <std::floating_point Float>
+extrapolation_integrator<Float>::extrapolation_integrator(const timestep<Float> &ts, const std::vector<Float> &vars,
+                                                          const Float tolerance, const std::uint32_t columns)
+    : state(vars, 1), ts(ts), tolerance(tolerance), m_columns(columns), m_sequences(columns), m_table(columns),
+      m_cost(columns), m_steps(columns), m_work(columns)
+{
+    KIT_ASSERT_ERROR(columns >= 3, "The extrapolation table must have at least 3 columns")
+    m_cost[0] = 3;
+    for (std::uint32_t i = 1; i < columns; i++)
+        m_cost[i] = m_cost[i - 1] + 2 * (i + 1);
+
+    // Initial guess from Hairer & Wanner's ODEX: tighter tolerances start at higher orders
+    const Float guess = -std::log10(tolerance) * 0.6f + 1.5f;
+    m_target = std::clamp((std::uint32_t)std::max(guess, static_cast<Float>(1.f)), 1u, columns - 2);
+}
+
+template <std::floating_point Float> void extrapolation_integrator<Float>::resize_buffers()
+{
+    const std::size_t size = state.size();
+    for (std::uint32_t i = 0; i < m_columns; i++)
+    {
+        m_sequences[i].result.resize(size);
+        m_sequences[i].current.resize(size);
+        m_table[i].resize(size);
+    }
+}
+
+template <std::floating_point Float>
+void extrapolation_integrator<Float>::extrapolate(const std::uint32_t column, const Float step)
+{
+    KIT_PERF_SCOPE("rk::extrapolation_integrator::extrapolate")
+    m_table[column] = m_sequences[column].result;
+    if (column == 0)
+    {
+        m_error = std::numeric_limits<Float>::max();
+        return;
+    }
+
+    for (std::uint32_t j = column; j > 0; j--)
+    {
+        const Float ratio = static_cast<Float>(column + 1) / static_cast<Float>(j);
+        const Float factor = ratio * ratio - 1.f;
+        for (std::size_t i = 0; i < state.size(); i++)
+            m_table[j - 1][i] = m_table[j][i] + (m_table[j][i] - m_table[j - 1][i]) / factor;
+    }
+
+    Float error = 0.f;
+    for (std::size_t i = 0; i < state.size(); i++)
+        error += (m_table[0][i] - m_table[1][i]) * (m_table[0][i] - m_table[1][i]);
+    m_error = std::max(error, tolerance / TOL_PART);
+
+    // The error is squared and the estimate is of order 2 * column + 1
+    const Float factor = SAFETY_FACTOR * std::pow(tolerance / m_error, 0.5f / static_cast<Float>(2 * column + 1));
+    m_steps[column] = step * std::clamp(factor, static_cast<Float>(MIN_FACTOR), static_cast<Float>(MAX_FACTOR));
+    m_work[column] = static_cast<Float>(m_cost[column]) / m_steps[column];
+}
+
+template <std::floating_point Float> void extrapolation_integrator<Float>::select_order(const std::uint32_t column)
+{
+    std::uint32_t target = column;
+    if (column > 1 && m_work[column - 1] < 0.8f * m_work[column])
+        target = column - 1;
+    else if (column + 3 <= m_columns && (column == 1 || m_work[column] < 0.9f * m_work[column - 1]))
+        target = column + 1;
+    target = std::min(target, m_columns - 2);
+
+    if (target > column)
+        ts.value = m_steps[column] * static_cast<Float>(m_cost[target]) / static_cast<Float>(m_cost[column]);
+    else
+        ts.value = m_steps[target];
+    m_target = target;
+}
+
+template <std::floating_point Float> std::uint32_t extrapolation_integrator<Float>::columns() const
+{
+    return m_columns;
+}
+template <std::floating_point Float> std::uint32_t extrapolation_integrator<Float>::order() const
+{
+    return 2 * m_target + 2;
+}
+
+template <std::floating_point Float> Float extrapolation_integrator<Float>::error() const
+{
+    return m_error;
+}
+template <std::floating_point Float> bool extrapolation_integrator<Float>::valid() const
+{
+    return m_valid;
+}
+
+template class extrapolation_integrator<float>;
+template class extrapolation_integrator<double>;
+template class extrapolation_integrator<long double>;
+} // namespace rk
@@ -17,7 +17,7 @@ std::vector<Float> integrator<Float>::generate_solution(const Float timestep, co
                                                         const array1 &coefs)
 {
     KIT_PERF_SCOPE("rk::integrator::generate_solution")
-    static std::vector<Float> sol;
+    static thread_local std::vector<Float> sol;
     sol.clear();
     for (std::size_t j = 0; j < vars.size(); j++)
     {
@@ -0,0 +1,191 @@
+#include "rk/internal/pch.hpp"
+#include "rk/integration/multirate_integrator.hpp"
+#include <algorithm>
+#include <cmath>
+#define SAFETY_FACTOR 0.85f
+#define MIN_FACTOR 0.2f
+#define MAX_FACTOR 4.f
+
+namespace rk
+{
+template <std::floating_point Float>
+multirate_integrator<Float>::multirate_integrator(const butcher_tableau<Float> &bt, const partition &groups,
+                                                  const timestep<Float> &ts, const std::vector<Float> &vars,
+                                                  const Float tolerance)
+    : m_partition(groups), m_vars(vars)
+{
+    KIT_ASSERT_ERROR(!groups.empty(), "There must be at least one rate group")
+    m_groups.reserve(groups.size());
+    for (std::size_t g = 0; g < groups.size(); g++)
+    {
+        m_groups.emplace_back(bt, ts, std::vector<Float>{}, tolerance);
+        for (std::size_t i = 0; i < groups[g].size(); i++)
+        {
+            const std::size_t index = groups[g][i];
+            if (index >= m_owners.size())
+            {
+                m_owners.resize(index + 1);
+                m_positions.resize(index + 1);
+            }
+            m_owners[index] = g;
+            m_positions[index] = i;
+        }
+    }
+    gather();
+}
+
+template <std::floating_point Float> void multirate_integrator<Float>::couple(const std::size_t group, const Float time)
+{
+    const Float span = time - elapsed;
+    for (std::size_t g = 0; g < group; g++)
+        for (const std::size_t index : m_partition[g])
+            m_coupled[index] = interpolated(index, span);
+    extrapolate(group, time);
+}
+
+template <std::floating_point Float>
+void multirate_integrator<Float>::extrapolate(const std::size_t group, const Float time)
+{
+    const Float span = time - elapsed;
+    for (std::size_t g = group + 1; g < m_groups.size(); g++)
+        for (const std::size_t index : m_partition[g])
+            m_coupled[index] = extrapolated(index, span);
+}
+
+// Quadratic through the start of the previous macro step and both ends of the current one, when available. Computed
+// once the group has been advanced, so that faster groups only evaluate it while sub-cycling
+template <std::floating_point Float> void multirate_integrator<Float>::interpolation(const std::size_t group)
+{
+    const Float spread = m_macro_step + m_history_steps[0];
+    for (const std::size_t index : m_partition[group])
+    {
+        const Float slope = m_macro_step > 0.f ? (m_vars[index] - m_start[index]) / m_macro_step : 0.f;
+        m_interpolation_slopes[index] = slope;
+        m_interpolation_curvatures[index] = m_degree > 0 ? (slope - m_slopes[index]) / spread : 0.f;
+    }
+}
+
+// Newton divided differences through the starts of the current and two previous macro steps
+template <std::floating_point Float> void multirate_integrator<Float>::compute_derivatives()
+{
+    m_slopes.assign(m_vars.size(), 0.f);
+    m_curvatures.assign(m_vars.size(), 0.f);
+    m_interpolation_slopes.assign(m_vars.size(), 0.f);
+    m_interpolation_curvatures.assign(m_vars.size(), 0.f);
+
+    m_degree = 0;
+    for (std::size_t i = 0; i < 2 && m_history_steps[i] > 0.f && m_history[i].size() == m_vars.size(); i++)
+        m_degree++;
+
+    if (m_degree > 0)
+        for (std::size_t i = 0; i < m_vars.size(); i++)
+            m_slopes[i] = (m_start[i] - m_history[0][i]) / m_history_steps[0];
+    if (m_degree > 1)
+        for (std::size_t i = 0; i < m_vars.size(); i++)
+        {
+            const Float previous = (m_history[0][i] - m_history[1][i]) / m_history_steps[1];
+            m_curvatures[i] = (m_slopes[i] - previous) / (m_history_steps[0] + m_history_steps[1]);
+        }
+}
+
+// The extrapolation error grows with the span to the power of the extrapolation degree plus one, so its effect on the
+// group's solution is roughly the macro step times the derivative mismatch it causes at the end, over that power plus
+// one
+template <std::floating_point Float>
+Float multirate_integrator<Float>::coupling_error(const std::vector<Float> &guess,
+                                                 const std::vector<Float> &actual) const
+{
+    KIT_ASSERT_ERROR(guess.size() == actual.size(),
+                     "ODE function must return a vector of the same size as the group's state vector")
+    const Float scale = m_macro_step / static_cast<Float>(m_degree + 2);
+    Float result = 0.f;
+    for (std::size_t i = 0; i < guess.size(); i++)
+    {
+        const Float diff = scale * (actual[i] - guess[i]);
+        result += diff * diff;
+    }
+    return result;
+}
+
+// Errors are squared and the coupling error is of order degree + 2 in the macro step
+template <std::floating_point Float> Float multirate_integrator<Float>::coupling_factor(const Float ratio) const
+{
+    const Float exponent = 0.5f / static_cast<Float>(m_degree + 2);
+    const Float factor = SAFETY_FACTOR * std::pow(1.f / std::max(ratio, 1.f / TOL_PART), exponent);
+    return std::clamp(factor, static_cast<Float>(MIN_FACTOR), static_cast<Float>(MAX_FACTOR));
+}
+
+template <std::floating_point Float> void multirate_integrator<Float>::gather()
+{
+    KIT_PERF_SCOPE("rk::multirate_integrator::gather")
+    if (m_vars.empty())
+        return;
+
+    std::vector<Float> group_vars;
+    for (std::size_t g = 0; g < m_groups.size(); g++)
+    {
+        group_vars.clear();
+        for (const std::size_t index : m_partition[g])
+        {
+            KIT_ASSERT_ERROR(index < m_vars.size(), "Index exceeds container size: {0}", index)
+            group_vars.push_back(m_vars[index]);
+        }
+        m_groups[g].state.vars(group_vars);
+    }
+}
+
+template <std::floating_point Float> void multirate_integrator<Float>::scatter(const std::size_t group)
+{
+    const std::vector<Float> &group_vars = m_groups[group].state.vars();
+    for (std::size_t i = 0; i < group_vars.size(); i++)
+        m_vars[m_partition[group][i]] = group_vars[i];
+}
+
+template <std::floating_point Float> const std::vector<Float> &multirate_integrator<Float>::vars() const
+{
+    return m_vars;
+}
+template <std::floating_point Float> void multirate_integrator<Float>::vars(const std::vector<Float> &vars)
+{
+    m_vars = vars;
+    m_history_steps = {};
+    m_coupling_step = 0.f;
+    gather();
+}
+
+template <std::floating_point Float> Float multirate_integrator<Float>::operator[](const std::size_t index) const
+{
+    KIT_ASSERT_ERROR(index < m_vars.size(), "Index exceeds container size: {0}", index)
+    return m_vars[index];
+}
+
+template <std::floating_point Float> std::size_t multirate_integrator<Float>::groups() const
+{
+    return m_groups.size();
+}
+template <std::floating_point Float>
+const integrator<Float> &multirate_integrator<Float>::group(const std::size_t index) const
+{
+    KIT_ASSERT_ERROR(index < m_groups.size(), "Index exceeds container size: {0}", index)
+    return m_groups[index];
+}
+template <std::floating_point Float> integrator<Float> &multirate_integrator<Float>::group(const std::size_t index)
+{
+    KIT_ASSERT_ERROR(index < m_groups.size(), "Index exceeds container size: {0}", index)
+    return m_groups[index];
+}
+
+template <std::floating_point Float>
+const typename multirate_integrator<Float>::partition &multirate_integrator<Float>::indices() const
+{
+    return m_partition;
+}
+template <std::floating_point Float> Float multirate_integrator<Float>::macro_step() const
+{
+    return m_macro_step;
+}
+
+template class multirate_integrator<float>;
+template class multirate_integrator<double>;
+template class multirate_integrator<long double>;
+} // namespace rk
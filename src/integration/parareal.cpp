@@ -0,0 +1,59 @@
+#include "rk/internal/pch.hpp"
+#include "rk/integration/parareal.hpp"
+#include <algorithm>
+
+namespace rk
+{
+template <std::floating_point Float>
+parareal<Float>::parareal(const integrator<Float> &coarse, const integrator<Float> &fine, const std::uint32_t slices,
+                          const Float tolerance, const std::uint32_t max_iterations)
+    : tolerance(tolerance), max_iterations(max_iterations), m_coarse(coarse), m_coarse_work(coarse),
+      m_fine_template(fine), m_fine(slices, fine), m_times(slices + 1), m_boundaries(slices + 1),
+      m_coarse_solutions(slices), m_fine_solutions(slices), m_fine_times(slices), m_fine_valid(slices)
+{
+    KIT_ASSERT_ERROR(slices > 0, "There must be at least one time slice")
+}
+
+template <std::floating_point Float>
+void parareal<Float>::prepare(const std::vector<Float> &vars, const Float begin, const Float end)
+{
+    m_report = {};
+    m_valid = true;
+
+    const std::uint32_t slices = (std::uint32_t)m_fine.size();
+    const Float length = (end - begin) / static_cast<Float>(slices);
+    for (std::uint32_t i = 0; i < slices; i++)
+        m_times[i] = begin + static_cast<Float>(i) * length;
+    m_times[slices] = end;
+
+    m_boundaries[0] = vars;
+    std::fill(m_fine_times.begin(), m_fine_times.end(), 0.0);
+    std::fill(m_fine_valid.begin(), m_fine_valid.end(), 1);
+}
+
+template <std::floating_point Float> const std::vector<Float> &parareal<Float>::vars() const
+{
+    return m_boundaries.back();
+}
+template <std::floating_point Float> const std::vector<std::vector<Float>> &parareal<Float>::boundaries() const
+{
+    return m_boundaries;
+}
+
+template <std::floating_point Float> std::uint32_t parareal<Float>::slices() const
+{
+    return (std::uint32_t)m_fine.size();
+}
+template <std::floating_point Float> const typename parareal<Float>::report &parareal<Float>::last_report() const
+{
+    return m_report;
+}
+template <std::floating_point Float> bool parareal<Float>::valid() const
+{
+    return m_valid;
+}
+
+template class parareal<float>;
+template class parareal<double>;
+template class parareal<long double>;
+} // namespace rk
@@ -0,0 +1,126 @@
+#include "rk/internal/pch.hpp"
+#include "rk/integration/tableau_autotuner.hpp"
+#include <limits>
+
+namespace rk
+{
+template <std::floating_point Float>
+tableau_autotuner<Float>::candidate::candidate(const butcher_tableau<Float> &tableau,
+                                               const std::uint32_t reiterations)
+    : tableau(tableau), reiterations(reiterations)
+{
+    KIT_ASSERT_ERROR(reiterations != 0 || tableau.embedded,
+                     "Candidates without an embedded solution must be integrated reiteratively")
+}
+
+template <std::floating_point Float> double tableau_autotuner<Float>::candidate::cost() const
+{
+    if (simulated <= 0.f)
+        return std::numeric_limits<double>::max();
+    return wall_time / (double)simulated;
+}
+
+template <std::floating_point Float> Float tableau_autotuner<Float>::candidate::mean_step() const
+{
+    return steps > 0 ? simulated / static_cast<Float>(steps) : 0.f;
+}
+
+template <std::floating_point Float> double tableau_autotuner<Float>::candidate::mean_rhs_time() const
+{
+    return evaluations > 0 ? rhs_time / evaluations : 0.0;
+}
+
+template <std::floating_point Float> Float tableau_autotuner<Float>::candidate::rejection_rate() const
+{
+    const std::uint32_t per_attempt = tableau.stages * (reiterations + 1);
+    const std::uint32_t attempts = evaluations / per_attempt;
+    if (attempts == 0)
+        return 0.f;
+    return 1.f - static_cast<Float>(steps) / static_cast<Float>(attempts);
+}
+
+template <std::floating_point Float> void tableau_autotuner<Float>::candidate::reset()
+{
+    rhs_time = 0.0;
+    wall_time = 0.0;
+    simulated = 0.f;
+    evaluations = 0;
+    steps = 0;
+}
+
+template <std::floating_point Float>
+tableau_autotuner<Float>::tableau_autotuner(const std::uint32_t window, const std::uint32_t period)
+    : tableau_autotuner({{butcher_tableau<Float>::rkf45},
+                         {butcher_tableau<Float>::rkfck45},
+                         {butcher_tableau<Float>::rkf78},
+                         {butcher_tableau<Float>::rk4, 2}},
+                        window, period)
+{
+}
+
+template <std::floating_point Float>
+tableau_autotuner<Float>::tableau_autotuner(const std::vector<candidate> &candidates, const std::uint32_t window,
+                                            const std::uint32_t period)
+    : window(window), period(period), m_candidates(candidates)
+{
+    KIT_ASSERT_ERROR(!candidates.empty(), "There must be at least one candidate tableau")
+    KIT_ASSERT_ERROR(window > 0, "The calibration window must contain at least one step")
+}
+
+template <std::floating_point Float>
+void tableau_autotuner<Float>::install(integrator<Float> &integ, const std::size_t index)
+{
+    integ.tableau(m_candidates[index].tableau);
+    m_active = index;
+}
+
+template <std::floating_point Float> void tableau_autotuner<Float>::next_candidate(integrator<Float> &integ)
+{
+    m_window_steps = 0;
+    if (++m_calibrated < m_candidates.size())
+        return;
+
+    m_selected = 0;
+    for (std::size_t i = 1; i < m_candidates.size(); i++)
+        if (m_candidates[i].cost() < m_candidates[m_selected].cost())
+            m_selected = i;
+
+    if (m_active != m_selected)
+        install(integ, m_selected);
+    m_calibrating = false;
+    m_since_calibration = 0;
+}
+
+template <std::floating_point Float> void tableau_autotuner<Float>::recalibrate()
+{
+    for (candidate &cand : m_candidates)
+        cand.reset();
+    m_calibrated = 0;
+    m_window_steps = 0;
+    m_calibrating = true;
+}
+
+template <std::floating_point Float>
+const std::vector<typename tableau_autotuner<Float>::candidate> &tableau_autotuner<Float>::candidates() const
+{
+    return m_candidates;
+}
+template <std::floating_point Float>
+const typename tableau_autotuner<Float>::candidate &tableau_autotuner<Float>::selected() const
+{
+    return m_candidates[m_selected];
+}
+template <std::floating_point Float> std::size_t tableau_autotuner<Float>::selection() const
+{
+    return m_selected;
+}
+
+template <std::floating_point Float> bool tableau_autotuner<Float>::calibrating() const
+{
+    return m_calibrating;
+}
+
+template class tableau_autotuner<float>;
+template class tableau_autotuner<double>;
+template class tableau_autotuner<long double>;
+} // namespace rk